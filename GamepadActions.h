@@ -0,0 +1,484 @@
+// MIT License
+
+// Copyright (c) 2022 Jashen Low
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#ifndef _GAMEPAD_ACTIONS_H_
+#define _GAMEPAD_ACTIONS_H_
+
+//Logical action mapping. Actions are evaluated from ActionInputs::Gather, or automatically by Gamepad::Tick.
+
+#include "GamepadCore.h"
+#include <vector>
+#include <algorithm>
+
+constexpr uint16_t GP_MAX_ACTIONS	= 0x8000;	//Maximum number of actions per ActionMap, so that value slots fit in 16 bits
+constexpr uint16_t GP_ACTION_NONE	= 0xFFFF;	//Returned by ActionMap::AddAction on failure
+
+namespace GpDef
+{
+	enum AxisID : uint8_t
+	{
+		AXIS_TRIGGER_L,
+		AXIS_TRIGGER_R,
+		AXIS_THUMB_L_X,
+		AXIS_THUMB_L_Y,
+		AXIS_THUMB_R_X,
+		AXIS_THUMB_R_Y,
+		AXIS_COUNT
+	};
+
+	enum ActionType : uint8_t
+	{
+		ACTION_DIGITAL,
+		ACTION_AXIS_1D,
+		ACTION_AXIS_2D
+	};
+
+	enum ActionComponent : uint8_t
+	{
+		COMPONENT_X,
+		COMPONENT_Y		//Only valid for ACTION_AXIS_2D
+	};
+
+	typedef uint16_t ActionID;
+
+	struct ActionInputs	//Per-tick button masks and axes of all controllers, as consumed by ActionMap
+	{
+		uint16_t	Buttons[GP_MAX_COUNT];				//Bitmask (See definition for GpDef::ButtonID)
+		float		Axes[GP_MAX_COUNT][AXIS_COUNT];		//Same ranges as AnalogStruct
+
+		ActionInputs()
+		{
+			Reset();
+		}
+
+		inline void Reset()
+		{
+			memset(this, 0, sizeof(ActionInputs));
+		}
+
+		inline void Set(const DeviceID& index, const DigitalStruct& digital, const AnalogStruct& analog)
+		{
+			Buttons[index]						= digital.ToMask();
+			Axes[index][AXIS_TRIGGER_L]			= analog.Trigger_L;
+			Axes[index][AXIS_TRIGGER_R]			= analog.Trigger_R;
+			Axes[index][AXIS_THUMB_L_X]			= analog.Thumb_L_X;
+			Axes[index][AXIS_THUMB_L_Y]			= analog.Thumb_L_Y;
+			Axes[index][AXIS_THUMB_R_X]			= analog.Thumb_R_X;
+			Axes[index][AXIS_THUMB_R_Y]			= analog.Thumb_R_Y;
+		}
+
+		//Reads the current states of all controllers from a Gamepad or GamepadCore.
+		template<typename GamepadT>
+		inline void Gather(GamepadT& gamepad)
+		{
+			for (uint8_t i = 0; i < GP_MAX_COUNT; i++)
+				Set((DeviceID)i, gamepad.GetDigitalStates((DeviceID)i), gamepad.GetAnalogStates((DeviceID)i));
+		}
+	};
+
+	struct ActionValue
+	{
+		float X;
+		float Y;
+	};
+
+	/*
+	* Maps logical actions to physical controls. Bindings are added at load time, then Compile flattens them into
+	* one table per binding kind so that Evaluate is a single pass over each table with no branching on the binding kind.
+	* Several ActionMaps can be compiled up front and swapped with Gamepad::SetActionMap, which primes the new map.
+	*/
+	class ActionMap
+	{
+	public:
+		ActionMap() {}
+
+		/*
+		* Description	 :	Declares a new logical action.
+		* Return		 :  ID of the action, used for binding and reading it, or GP_ACTION_NONE if GP_MAX_ACTIONS is reached.
+		*/
+		ActionID AddAction(const ActionType& type)
+		{
+			if (types.size() >= GP_MAX_ACTIONS)
+			{
+				GpReportError(ERR_ACTIONS_FULL, __FUNCTION__);
+				return GP_ACTION_NONE;
+			}
+
+			types.push_back(type);
+			return (ActionID)(types.size() - 1);
+		}
+
+		/*
+		* Description	 :	Binds a digital action to a chord. The action is active while ALL buttons in "buttons" are held.
+		* Return		 :
+		*/
+		void BindChord(const ActionID& action, const DeviceID& device, const uint16_t& buttons)
+		{
+			if (!IsValidBinding(action, device, ACTION_DIGITAL, COMPONENT_X) || (buttons == 0))
+			{
+				GpReportError(ERR_INVALID_BINDING, __FUNCTION__);
+				return;
+			}
+
+			Binding binding = { BIND_CHORD, action, device, COMPONENT_X, AXIS_COUNT, buttons, 0, 0.0f };
+			bindings.push_back(binding);
+		}
+
+		/*
+		* Description	 :	Binds a digital action to an axis. The action is active while the axis is at or beyond "threshold".
+		*                   A negative threshold activates the action in the negative direction.
+		* Return		 :
+		*/
+		void BindAxisThreshold(const ActionID& action, const DeviceID& device, const AxisID& axis, const float& threshold)
+		{
+			if (!IsValidBinding(action, device, ACTION_DIGITAL, COMPONENT_X) || (axis >= AXIS_COUNT) || (threshold == 0.0f))
+			{
+				GpReportError(ERR_INVALID_BINDING, __FUNCTION__);
+				return;
+			}
+
+			Binding binding = { BIND_THRESHOLD, action, device, COMPONENT_X, axis, 0, 0, threshold };
+			bindings.push_back(binding);
+		}
+
+		/*
+		* Description	 :	Binds one component of an axis action to a physical axis, multiplied by "scale".
+		* Return		 :
+		*/
+		void BindAxis(const ActionID& action, const DeviceID& device, const AxisID& axis, const float& scale = 1.0f, const ActionComponent& component = COMPONENT_X)
+		{
+			if (!IsValidAxisBinding(action, device, component) || (axis >= AXIS_COUNT))
+			{
+				GpReportError(ERR_INVALID_BINDING, __FUNCTION__);
+				return;
+			}
+
+			Binding binding = { BIND_AXIS, action, device, component, axis, 0, 0, scale };
+			bindings.push_back(binding);
+		}
+
+		/*
+		* Description	 :	Binds one component of an axis action to buttons. Holding any button in "negative" gives -1,
+		*                   holding any button in "positive" gives +1, and holding both gives 0.
+		* Return		 :
+		*/
+		void BindButtons(const ActionID& action, const DeviceID& device, const uint16_t& negative, const uint16_t& positive, const ActionComponent& component = COMPONENT_X)
+		{
+			if (!IsValidAxisBinding(action, device, component) || ((negative | positive) == 0))
+			{
+				GpReportError(ERR_INVALID_BINDING, __FUNCTION__);
+				return;
+			}
+
+			Binding binding = { BIND_BUTTONS, action, device, component, AXIS_COUNT, negative, positive, 0.0f };
+			bindings.push_back(binding);
+		}
+
+		/*
+		* Description	 :	Removes all actions and bindings.
+		* Return		 :
+		*/
+		void Clear()
+		{
+			types.clear();
+			bindings.clear();
+			Compile();
+		}
+
+		/*
+		* Description	 :	Builds the flat binding tables used by Evaluate. Bindings to ID_ANY are expanded for every controller.
+		*                   IMPORTANT: This has to be called after adding actions or bindings, otherwise they are not evaluated.
+		*                   NOTE: This clears all action states. Call Prime afterwards when recompiling the active map mid-session.
+		* Return		 :
+		*/
+		void Compile()
+		{
+			chords.clear();
+			thresholds.clear();
+			axes.clear();
+			buttonAxes.clear();
+
+			for (const Binding& binding : bindings)
+			{
+				const uint8_t firstDevice = (binding.Device == ID_ANY) ? 0 : binding.Device;
+				const uint8_t lastDevice  = (binding.Device == ID_ANY) ? GP_MAX_COUNT - 1 : binding.Device;
+
+				for (uint8_t device = firstDevice; device <= lastDevice; device++)
+				{
+					switch (binding.Kind)
+					{
+					case BIND_CHORD:
+					{
+						ChordEntry entry = { binding.Action, device, binding.MaskA };
+						chords.push_back(entry);
+						break;
+					}
+					case BIND_THRESHOLD:
+					{
+						ThresholdEntry entry = { binding.Action, device, binding.Axis, binding.Value };
+						thresholds.push_back(entry);
+						break;
+					}
+					case BIND_AXIS:
+					{
+						AxisEntry entry = { (uint16_t)(binding.Action * 2 + binding.Component), device, binding.Axis, binding.Value };
+						axes.push_back(entry);
+						break;
+					}
+					case BIND_BUTTONS:
+					{
+						ButtonAxisEntry entry = { (uint16_t)(binding.Action * 2 + binding.Component), device, binding.MaskA, binding.MaskB };
+						buttonAxes.push_back(entry);
+						break;
+					}
+					}
+				}
+			}
+
+			//Group entries by controller so that each table is read in input order
+			std::stable_sort(chords.begin(), chords.end(), [](const ChordEntry& a, const ChordEntry& b) { return a.Device < b.Device; });
+			std::stable_sort(thresholds.begin(), thresholds.end(), [](const ThresholdEntry& a, const ThresholdEntry& b) { return a.Device < b.Device; });
+			std::stable_sort(axes.begin(), axes.end(), [](const AxisEntry& a, const AxisEntry& b) { return a.Device < b.Device; });
+			std::stable_sort(buttonAxes.begin(), buttonAxes.end(), [](const ButtonAxisEntry& a, const ButtonAxisEntry& b) { return a.Device < b.Device; });
+
+			digital.assign(types.size(), 0);
+			prevDigital.assign(types.size(), 0);
+			values.assign(types.size() * 2, 0.0f);
+		}
+
+		/*
+		* Description	 :	Updates all action states from the given inputs. Digital actions combine their bindings with OR,
+		*                   axis actions take the value with the largest magnitude for each component.
+		*                   NOTE: This is called by Gamepad::Tick on the active ActionMap.
+		* Return		 :
+		*/
+		void Evaluate(const ActionInputs& inputs)
+		{
+			digital.swap(prevDigital);
+			std::fill(digital.begin(), digital.end(), (uint8_t)0);
+			std::fill(values.begin(), values.end(), 0.0f);
+
+			for (const ChordEntry& entry : chords)
+				digital[entry.Action] |= (uint8_t)((inputs.Buttons[entry.Device] & entry.Mask) == entry.Mask);
+
+			for (const ThresholdEntry& entry : thresholds)
+			{
+				const float& value = inputs.Axes[entry.Device][entry.Axis];
+				digital[entry.Action] |= (uint8_t)((entry.Threshold > 0.0f) ? (value >= entry.Threshold) : (value <= entry.Threshold));
+			}
+
+			for (const AxisEntry& entry : axes)
+				KeepLargest(values[entry.Slot], inputs.Axes[entry.Device][entry.Axis] * entry.Scale);
+
+			for (const ButtonAxisEntry& entry : buttonAxes)
+			{
+				const uint16_t& held = inputs.Buttons[entry.Device];
+				KeepLargest(values[entry.Slot], (float)((held & entry.Positive) != 0) - (float)((held & entry.Negative) != 0));
+			}
+		}
+
+		/*
+		* Description	 :	Evaluates the given inputs as both the current and previous states, so that the next Evaluate
+		*                   only reports presses and releases that happen from now on.
+		*                   NOTE: This is called by Gamepad::SetActionMap. Call it after Compile when rebinding mid-session.
+		* Return		 :
+		*/
+		void Prime(const ActionInputs& inputs)
+		{
+			Evaluate(inputs);
+			std::copy(digital.begin(), digital.end(), prevDigital.begin());
+		}
+
+		/*
+		* Description	 :	Returns the number of declared actions.
+		* Return		 :  Number of actions.
+		*/
+		size_t GetActionCount() const { return types.size(); }
+
+		/*
+		* Description	 :	Returns whether a digital action is active.
+		* Return		 :  true = active, false = not active.
+		*/
+		bool GetDigital(const ActionID& action) const
+		{
+			if (!IsActionType(action, ACTION_DIGITAL))
+			{
+				GpReportError(ERR_INVALID_ACTION, __FUNCTION__);
+				return false;
+			}
+
+			return digital[action] != 0;
+		}
+
+		/*
+		* Description	 :	Returns whether a digital action became active on the latest evaluation.
+		* Return		 :  true = pressed, false = not pressed.
+		*/
+		bool IsPressed(const ActionID& action) const
+		{
+			if (!IsActionType(action, ACTION_DIGITAL))
+			{
+				GpReportError(ERR_INVALID_ACTION, __FUNCTION__);
+				return false;
+			}
+
+			return digital[action] && !prevDigital[action];
+		}
+
+		/*
+		* Description	 :	Returns whether a digital action became inactive on the latest evaluation.
+		* Return		 :  true = released, false = not released.
+		*/
+		bool IsReleased(const ActionID& action) const
+		{
+			if (!IsActionType(action, ACTION_DIGITAL))
+			{
+				GpReportError(ERR_INVALID_ACTION, __FUNCTION__);
+				return false;
+			}
+
+			return !digital[action] && prevDigital[action];
+		}
+
+		/*
+		* Description	 :	Returns the value of a 1D axis action, or the X component of a 2D axis action.
+		* Return		 :  Axis value.
+		*/
+		float GetAxis(const ActionID& action) const
+		{
+			if (!IsActionType(action, ACTION_AXIS_1D) && !IsActionType(action, ACTION_AXIS_2D))
+			{
+				GpReportError(ERR_INVALID_ACTION, __FUNCTION__);
+				return 0.0f;
+			}
+
+			return values[action * 2];
+		}
+
+		/*
+		* Description	 :	Returns both components of a 2D axis action.
+		* Return		 :  ActionValue.
+		*/
+		ActionValue GetAxis2D(const ActionID& action) const
+		{
+			ActionValue result = { 0.0f, 0.0f };
+
+			if (!IsActionType(action, ACTION_AXIS_2D))
+			{
+				GpReportError(ERR_INVALID_ACTION, __FUNCTION__);
+				return result;
+			}
+
+			result.X = values[action * 2];
+			result.Y = values[action * 2 + 1];
+			return result;
+		}
+
+	private:
+		enum BindingKind : uint8_t
+		{
+			BIND_CHORD,
+			BIND_THRESHOLD,
+			BIND_AXIS,
+			BIND_BUTTONS
+		};
+
+		struct Binding
+		{
+			BindingKind		Kind;
+			ActionID		Action;
+			uint8_t			Device;
+			ActionComponent	Component;
+			AxisID			Axis;
+			uint16_t		MaskA;
+			uint16_t		MaskB;
+			float			Value;
+		};
+
+		struct ChordEntry
+		{
+			ActionID	Action;
+			uint8_t		Device;
+			uint16_t	Mask;
+		};
+
+		struct ThresholdEntry
+		{
+			ActionID	Action;
+			uint8_t		Device;
+			uint8_t		Axis;
+			float		Threshold;
+		};
+
+		struct AxisEntry
+		{
+			uint16_t	Slot;	//Index into values (action * 2 + component)
+			uint8_t		Device;
+			uint8_t		Axis;
+			float		Scale;
+		};
+
+		struct ButtonAxisEntry
+		{
+			uint16_t	Slot;	//Index into values (action * 2 + component)
+			uint8_t		Device;
+			uint16_t	Negative;
+			uint16_t	Positive;
+		};
+
+		std::vector<ActionType>			types;
+		std::vector<Binding>			bindings;
+		std::vector<ChordEntry>			chords;
+		std::vector<ThresholdEntry>		thresholds;
+		std::vector<AxisEntry>			axes;
+		std::vector<ButtonAxisEntry>	buttonAxes;
+		std::vector<uint8_t>			digital;
+		std::vector<uint8_t>			prevDigital;
+		std::vector<float>				values;
+
+		inline bool IsActionType(const ActionID& action, const ActionType& type) const
+		{
+			return (action < types.size()) && (action < digital.size()) && (types[action] == type);
+		}
+
+		inline bool IsValidBinding(const ActionID& action, const DeviceID& device, const ActionType& type, const ActionComponent& component) const
+		{
+			return (action < types.size()) && (types[action] == type) &&
+				((device < GP_MAX_COUNT) || (device == ID_ANY)) &&
+				((component == COMPONENT_X) || (type == ACTION_AXIS_2D));
+		}
+
+		inline bool IsValidAxisBinding(const ActionID& action, const DeviceID& device, const ActionComponent& component) const
+		{
+			return (action < types.size()) &&
+				(IsValidBinding(action, device, ACTION_AXIS_1D, component) || IsValidBinding(action, device, ACTION_AXIS_2D, component));
+		}
+
+		static inline void KeepLargest(float& current, const float& value)
+		{
+			current = (std::abs(value) > std::abs(current)) ? value : current;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,44 @@
+// MIT License
+
+// Copyright (c) 2022 Jashen Low
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#ifndef _GAMEPAD_ASYNC_H_
+#define _GAMEPAD_ASYNC_H_
+
+//Asynchronous callback dispatching. (See GamepadCore::SetCallbackDispatcher)
+
+#include "GamepadCore.h"
+#include <future>
+
+namespace GpAsync
+{
+	/*
+	* Description	 :	Calls a connection callback on a separate thread.
+	* Return		 :
+	*/
+	inline void Dispatch(GpConnectCallback fcn, void* usr, GpDef::DeviceID gamepadID)
+	{
+		std::future<void> fut = std::async(std::launch::async, fcn, usr, gamepadID);
+	}
+}
+
+#endif
@@ -0,0 +1,1191 @@
+// MIT License
+
+// Copyright (c) 2022 Jashen Low
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#ifndef _GAMEPAD_CORE_H_
+#define _GAMEPAD_CORE_H_
+
+//Minimal core of the library: state types, Tick and getters. 
+//This header has no platform, iostream or threading dependencies. The full library is available through Gamepad.h.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+
+#ifdef _MSC_VER
+#pragma warning(disable:26812)	//Disable warning for unscoped enums
+#endif
+
+constexpr float DEFAULT_DEADZONE	= 0.04f;
+constexpr short GPID_DISCONNECTED	= -1;
+constexpr uint8_t GP_MAX_COUNT		= 4;	//Maximum number of controllers
+constexpr size_t GP_NAME_LEN		= 32;	//Maximum length of a product name, including the null terminator
+constexpr uint8_t GP_MAX_CALLBACKS	= 8;	//Maximum number of callbacks per event
+constexpr uint32_t GP_HISTORY_SIZE	= 64;	//Number of ticks kept per controller. Must be a power of 2.
+constexpr uint32_t GP_TICK_NONE		= 0;	//Tick numbers start at 1, so 0 means "never".
+
+static_assert((GP_HISTORY_SIZE & (GP_HISTORY_SIZE - 1)) == 0, "GP_HISTORY_SIZE must be a power of 2");
+
+namespace GpDef
+{
+	enum DeviceID : uint8_t
+	{
+		ID_0,
+		ID_1,
+		ID_2,
+		ID_3,
+		ID_ANY = 0xFF	//Only valid for action bindings
+	};
+
+	enum StreamType : uint8_t
+	{
+		STREAM_ALL,
+		STREAM_DIGITAL,
+		STREAM_ANALOG
+	};
+
+	enum ErrorCode : uint8_t
+	{
+		ERR_NONE,
+		ERR_INVALID_DEVICE,
+		ERR_INVALID_BUTTON,
+		ERR_INVALID_CALLBACK,
+		ERR_CALLBACKS_FULL,
+		ERR_INVALID_ACTION,		//Reported by GamepadActions.h
+		ERR_INVALID_BINDING,	//Reported by GamepadActions.h
+		ERR_ACTIONS_FULL		//Reported by GamepadActions.h
+	};
+
+	enum ButtonID : uint8_t	//Bit positions used by packed button masks
+	{
+		BTN_FACE_A,
+		BTN_FACE_B,
+		BTN_FACE_X,
+		BTN_FACE_Y,
+		BTN_DPAD_LEFT,
+		BTN_DPAD_RIGHT,
+		BTN_DPAD_UP,
+		BTN_DPAD_DOWN,
+		BTN_SHOULDER_LEFT,
+		BTN_SHOULDER_RIGHT,
+		BTN_THUMB_LEFT,
+		BTN_THUMB_RIGHT,
+		BTN_BACK,
+		BTN_START,
+		BTN_COUNT
+	};
+
+	inline uint16_t ButtonMask(const ButtonID& button)
+	{
+		return (uint16_t)(1u << button);
+	}
+
+	struct AnalogStruct
+	{
+		float Trigger_L;   //Value Range: [0 to 1]	
+		float Trigger_R;   //Value Range: [0 to 1]  
+		float Thumb_L_X;   //Value Range: [-1 to 1]
+		float Thumb_L_Y;   //Value Range: [-1 to 1]
+		float Thumb_R_X;   //Value Range: [-1 to 1]
+		float Thumb_R_Y;   //Value Range: [-1 to 1]
+		float Vibration_L; //Value Range: [0 to 1]
+		float Vibration_R; //Value Range: [0 to 1]
+
+		AnalogStruct()
+		{
+			Reset();
+		}
+
+		inline void Reset()
+		{
+			memset(this, 0, sizeof(AnalogStruct));
+		}
+
+		bool operator==(const AnalogStruct& other)
+		{
+			return (
+				Trigger_L == other.Trigger_L &&
+				Trigger_R == other.Trigger_R &&
+				Thumb_L_X == other.Thumb_L_X &&
+				Thumb_L_Y == other.Thumb_L_Y &&
+				Thumb_R_X == other.Thumb_R_X &&
+				Thumb_R_Y == other.Thumb_R_Y &&
+				Vibration_L == other.Vibration_L &&
+				Vibration_R == other.Vibration_R
+				);
+		}
+
+		bool operator!=(const AnalogStruct& other)
+		{
+			return (
+				Trigger_L != other.Trigger_L ||
+				Trigger_R != other.Trigger_R ||
+				Thumb_L_X != other.Thumb_L_X ||
+				Thumb_L_Y != other.Thumb_L_Y ||
+				Thumb_R_X != other.Thumb_R_X ||
+				Thumb_R_Y != other.Thumb_R_Y ||
+				Vibration_L != other.Vibration_L ||
+				Vibration_R != other.Vibration_R
+				);
+		}
+	};
+
+	struct DigitalStruct
+	{
+		bool Face_A;
+		bool Face_B;
+		bool Face_X;
+		bool Face_Y;
+		bool Dpad_Left;
+		bool Dpad_Right;
+		bool Dpad_Up;
+		bool Dpad_Down;
+		bool Shoulder_Left;
+		bool Shoulder_Right;
+		bool Thumb_Left;
+		bool Thumb_Right;
+		bool Back;
+		bool Start;
+
+		DigitalStruct()
+		{
+			Reset();
+		}
+
+		inline void Reset()
+		{
+			memset(this, 0, sizeof(DigitalStruct));
+		}
+
+		//Packs all buttons into a bitmask. (See definition for GpDef::ButtonID)
+		inline uint16_t ToMask() const
+		{
+			return (uint16_t)(
+				(Face_A         << BTN_FACE_A) |
+				(Face_B         << BTN_FACE_B) |
+				(Face_X         << BTN_FACE_X) |
+				(Face_Y         << BTN_FACE_Y) |
+				(Dpad_Left      << BTN_DPAD_LEFT) |
+				(Dpad_Right     << BTN_DPAD_RIGHT) |
+				(Dpad_Up        << BTN_DPAD_UP) |
+				(Dpad_Down      << BTN_DPAD_DOWN) |
+				(Shoulder_Left  << BTN_SHOULDER_LEFT) |
+				(Shoulder_Right << BTN_SHOULDER_RIGHT) |
+				(Thumb_Left     << BTN_THUMB_LEFT) |
+				(Thumb_Right    << BTN_THUMB_RIGHT) |
+				(Back           << BTN_BACK) |
+				(Start          << BTN_START)
+				);
+		}
+
+		inline void FromMask(const uint16_t& mask)
+		{
+			Face_A         = (bool)(mask & ButtonMask(BTN_FACE_A));
+			Face_B         = (bool)(mask & ButtonMask(BTN_FACE_B));
+			Face_X         = (bool)(mask & ButtonMask(BTN_FACE_X));
+			Face_Y         = (bool)(mask & ButtonMask(BTN_FACE_Y));
+			Dpad_Left      = (bool)(mask & ButtonMask(BTN_DPAD_LEFT));
+			Dpad_Right     = (bool)(mask & ButtonMask(BTN_DPAD_RIGHT));
+			Dpad_Up        = (bool)(mask & ButtonMask(BTN_DPAD_UP));
+			Dpad_Down      = (bool)(mask & ButtonMask(BTN_DPAD_DOWN));
+			Shoulder_Left  = (bool)(mask & ButtonMask(BTN_SHOULDER_LEFT));
+			Shoulder_Right = (bool)(mask & ButtonMask(BTN_SHOULDER_RIGHT));
+			Thumb_Left     = (bool)(mask & ButtonMask(BTN_THUMB_LEFT));
+			Thumb_Right    = (bool)(mask & ButtonMask(BTN_THUMB_RIGHT));
+			Back           = (bool)(mask & ButtonMask(BTN_BACK));
+			Start          = (bool)(mask & ButtonMask(BTN_START));
+		}
+
+		bool operator==(const DigitalStruct& other)
+		{
+			return (
+				Face_A == other.Face_A &&
+				Face_B == other.Face_B &&
+				Face_X == other.Face_X &&
+				Face_Y == other.Face_Y &&
+				Dpad_Left == other.Dpad_Left &&
+				Dpad_Right == other.Dpad_Right &&
+				Dpad_Up == other.Dpad_Up &&
+				Dpad_Down == other.Dpad_Down &&
+				Shoulder_Left == other.Shoulder_Left &&
+				Shoulder_Right == other.Shoulder_Right &&
+				Thumb_Left == other.Thumb_Left &&
+				Thumb_Right == other.Thumb_Right &&
+				Back == other.Back &&
+				Start == other.Start
+				);
+		}
+
+		bool operator!=(const DigitalStruct& other)
+		{
+			return (
+				Face_A != other.Face_A ||
+				Face_B != other.Face_B ||
+				Face_X != other.Face_X ||
+				Face_Y != other.Face_Y ||
+				Dpad_Left != other.Dpad_Left ||
+				Dpad_Right != other.Dpad_Right ||
+				Dpad_Up != other.Dpad_Up ||
+				Dpad_Down != other.Dpad_Down ||
+				Shoulder_Left != other.Shoulder_Left ||
+				Shoulder_Right != other.Shoulder_Right ||
+				Thumb_Left != other.Thumb_Left ||
+				Thumb_Right != other.Thumb_Right ||
+				Back != other.Back ||
+				Start != other.Start
+				);
+		}
+	};
+
+	struct DeadzoneStruct
+	{
+		float X;
+		float Y;
+
+		DeadzoneStruct()
+		{
+			Reset();
+		}
+
+		inline void Set(const float& setX, const float& setY)
+		{
+			X = std::abs(setX);
+			Y = std::abs(setY);
+		}
+
+		inline void Reset()
+		{
+			X = DEFAULT_DEADZONE;
+			Y = DEFAULT_DEADZONE;
+		}
+	};
+
+	struct ControlsStruct
+	{
+		AnalogStruct	Analog;
+		DigitalStruct	Digital;
+		DeadzoneStruct	Deadzone;
+
+		ControlsStruct()
+		{
+			Reset();
+		}
+
+		void Reset()
+		{
+			Analog.Reset();
+			Digital.Reset();
+			Deadzone.Reset();
+		}
+	};
+
+	struct InputSnapshot	//Compact copy of a controller's inputs for a single tick
+	{
+		uint64_t Timestamp;	//Microseconds, taken once per Tick
+		uint32_t Tick;
+		uint16_t Buttons;	//Bitmask (See definition for GpDef::ButtonID)
+		uint8_t  Trigger_L;	//Value Range: [0 to 255]
+		uint8_t  Trigger_R;	//Value Range: [0 to 255]
+		int16_t  Thumb_L_X;	//Value Range: [-32767 to 32767]
+		int16_t  Thumb_L_Y;	//Value Range: [-32767 to 32767]
+		int16_t  Thumb_R_X;	//Value Range: [-32767 to 32767]
+		int16_t  Thumb_R_Y;	//Value Range: [-32767 to 32767]
+
+		InputSnapshot()
+		{
+			Reset();
+		}
+
+		inline void Reset()
+		{
+			memset(this, 0, sizeof(InputSnapshot));
+		}
+
+		//Quantises the analog states (after deadzones are applied) and packs the digital states.
+		inline void Pack(const ControlsStruct& controls, const uint32_t& tick, const uint64_t& timestamp)
+		{
+			Timestamp = timestamp;
+			Tick      = tick;
+			Buttons   = controls.Digital.ToMask();
+			Trigger_L = (uint8_t)(controls.Analog.Trigger_L * 255.0f + 0.5f);
+			Trigger_R = (uint8_t)(controls.Analog.Trigger_R * 255.0f + 0.5f);
+			Thumb_L_X = (int16_t)(controls.Analog.Thumb_L_X * 32767.0f);
+			Thumb_L_Y = (int16_t)(controls.Analog.Thumb_L_Y * 32767.0f);
+			Thumb_R_X = (int16_t)(controls.Analog.Thumb_R_X * 32767.0f);
+			Thumb_R_Y = (int16_t)(controls.Analog.Thumb_R_Y * 32767.0f);
+		}
+
+		//Restores the analog and digital states. Vibration levels are not recorded and are left untouched.
+		inline void Unpack(AnalogStruct& analog, DigitalStruct& digital) const
+		{
+			analog.Trigger_L = Trigger_L / 255.0f;
+			analog.Trigger_R = Trigger_R / 255.0f;
+			analog.Thumb_L_X = Thumb_L_X / 32767.0f;
+			analog.Thumb_L_Y = Thumb_L_Y / 32767.0f;
+			analog.Thumb_R_X = Thumb_R_X / 32767.0f;
+			analog.Thumb_R_Y = Thumb_R_Y / 32767.0f;
+			digital.FromMask(Buttons);
+		}
+	};
+
+	struct InputHistory	//Ring buffer of the last GP_HISTORY_SIZE snapshots, indexed by tick number
+	{
+		InputSnapshot	Frames[GP_HISTORY_SIZE];
+		uint32_t		PressedTick[BTN_COUNT];		//Tick on which each button last went down
+		uint32_t		ReleasedTick[BTN_COUNT];	//Tick on which each button last went up
+		uint64_t		PressedTime[BTN_COUNT];		//Timestamp on which each button last went down
+		uint32_t		NewestTick;
+		uint32_t		Count;
+
+		InputHistory()
+		{
+			Reset();
+		}
+
+		inline void Reset()
+		{
+			for (uint32_t i = 0; i < GP_HISTORY_SIZE; i++)
+				Frames[i].Reset();
+
+			memset(PressedTick, 0, sizeof(PressedTick));
+			memset(ReleasedTick, 0, sizeof(ReleasedTick));
+			memset(PressedTime, 0, sizeof(PressedTime));
+			NewestTick = GP_TICK_NONE;
+			Count      = 0;
+		}
+
+		//Snapshots are expected to be pushed with consecutive tick numbers.
+		inline void Push(const InputSnapshot& snapshot)
+		{
+			const uint16_t prevButtons = (Count > 0) ? Newest().Buttons : 0;
+			uint16_t changed           = prevButtons ^ snapshot.Buttons;
+
+			//Only visit the buttons that changed state
+			while (changed)
+			{
+				const uint16_t bit = changed & (uint16_t)(~changed + 1);
+				uint8_t button     = 0;
+
+				while ((bit >> button) != 1)
+					button++;
+
+				if (snapshot.Buttons & bit)
+				{
+					PressedTick[button] = snapshot.Tick;
+					PressedTime[button] = snapshot.Timestamp;
+				}
+				else
+				{
+					ReleasedTick[button] = snapshot.Tick;
+				}
+
+				changed &= ~bit;
+			}
+
+			Frames[snapshot.Tick & (GP_HISTORY_SIZE - 1)] = snapshot;
+			NewestTick = snapshot.Tick;
+
+			if (Count < GP_HISTORY_SIZE)
+				Count++;
+		}
+
+		inline uint32_t OldestTick() const
+		{
+			return (Count > 0) ? NewestTick - Count + 1 : GP_TICK_NONE;
+		}
+
+		inline bool Contains(const uint32_t& tick) const
+		{
+			return (Count > 0) && (tick != GP_TICK_NONE) && (tick <= NewestTick) && (NewestTick - tick < Count);
+		}
+
+		//Returns nullptr if the tick is no longer (or not yet) in the history.
+		inline const InputSnapshot* Get(const uint32_t& tick) const
+		{
+			return Contains(tick) ? &Frames[tick & (GP_HISTORY_SIZE - 1)] : nullptr;
+		}
+
+		inline const InputSnapshot& Newest() const
+		{
+			return Frames[NewestTick & (GP_HISTORY_SIZE - 1)];
+		}
+
+		//Copies snapshots from firstTick to lastTick (inclusive) into "out", clamped to what is still in the history.
+		//Returns the number of snapshots copied.
+		inline uint32_t CopyRange(const uint32_t& firstTick, const uint32_t& lastTick, InputSnapshot* out) const
+		{
+			if ((Count == 0) || (out == nullptr) || (firstTick > lastTick))
+				return 0;
+
+			const uint32_t first = (firstTick < OldestTick()) ? OldestTick() : firstTick;
+			const uint32_t last  = (lastTick > NewestTick) ? NewestTick : lastTick;
+			uint32_t copied      = 0;
+
+			if (first > last)
+				return 0;
+
+			for (uint32_t t = first; t <= last; t++)
+				out[copied++] = Frames[t & (GP_HISTORY_SIZE - 1)];
+
+			return copied;
+		}
+
+		inline bool IsHeld(const ButtonID& button) const
+		{
+			return (Count > 0) && (Newest().Buttons & ButtonMask(button));
+		}
+
+		//Number of ticks the button has been held for, including the current one. 0 if not held.
+		inline uint32_t HeldTicks(const ButtonID& button) const
+		{
+			return IsHeld(button) ? NewestTick - PressedTick[button] + 1 : 0;
+		}
+
+		//Microseconds elapsed between the tick the button went down and the current one. 0 if not held.
+		inline uint64_t HeldTime(const ButtonID& button) const
+		{
+			return IsHeld(button) ? Newest().Timestamp - PressedTime[button] : 0;
+		}
+	};
+
+	struct RawPadState	//Unprocessed controller state, as reported by the platform backend
+	{
+		uint16_t Buttons;	//Bitmask (See definition for GpDef::ButtonID)
+		uint8_t  Trigger_L;	//Value Range: [0 to 255]
+		uint8_t  Trigger_R;	//Value Range: [0 to 255]
+		int16_t  Thumb_L_X;	//Value Range: [-32768 to 32767]
+		int16_t  Thumb_L_Y;	//Value Range: [-32768 to 32767]
+		int16_t  Thumb_R_X;	//Value Range: [-32768 to 32767]
+		int16_t  Thumb_R_Y;	//Value Range: [-32768 to 32767]
+
+		RawPadState()
+		{
+			Reset();
+		}
+
+		inline void Reset()
+		{
+			memset(this, 0, sizeof(RawPadState));
+		}
+	};
+
+	struct GamepadState
+	{
+		ControlsStruct		Controls;
+		ControlsStruct		PrevControls;
+		InputHistory		History;	//Not cleared by Reset, so that it remains continuous across disconnections
+		char				ProductName[GP_NAME_LEN];
+		RawPadState			PadState;
+		short				ID;
+		short				PrevID;
+
+		GamepadState()
+		{
+			Reset();
+		}
+
+		inline void Reset()
+		{
+			Controls.Reset();
+			memset(ProductName, '\0', GP_NAME_LEN);
+			PadState.Reset();
+			ID      = GPID_DISCONNECTED;
+			PrevID  = GPID_DISCONNECTED;
+		}
+	};
+}
+
+typedef void(*GpConnectCallback)(void* usr, GpDef::DeviceID gamepadID);
+typedef void(*GpCallbackDispatcher)(GpConnectCallback fcn, void* usr, GpDef::DeviceID gamepadID);
+typedef void(*GpErrorCallback)(void* usr, GpDef::ErrorCode code, const char* function);
+typedef void(*GpTickCallback)(void* usr);
+
+struct GpErrorHook
+{
+	GpErrorCallback	Fcn;
+	void*			Usr;
+	bool			Installed;	//Set by GpSetErrorCallback, even when Fcn is nullptr
+};
+
+inline GpErrorHook& GpGetErrorHook()
+{
+	static GpErrorHook hook = { nullptr, nullptr, false };	//Constant-initialized, no static constructor required
+	return hook;
+}
+
+/*
+* Description	 :	Sets a user-defined function to be called whenever a function receives invalid input. Pass nullptr to ignore errors.
+*                   NOTE: Gamepad.h installs a hook that prints to std::cerr if this was never called. (See GpDebug::ErrorToStderr)
+* Return		 :
+*/
+inline void GpSetErrorCallback(GpErrorCallback fcn, void* usr)
+{
+	GpGetErrorHook().Fcn       = fcn;
+	GpGetErrorHook().Usr       = usr;
+	GpGetErrorHook().Installed = true;
+}
+
+inline void GpReportError(const GpDef::ErrorCode& code, const char* function)
+{
+	const GpErrorHook& hook = GpGetErrorHook();
+
+	if (hook.Fcn != nullptr)
+		hook.Fcn(hook.Usr, code, function);
+}
+
+/*
+* Description	 :	Returns a description of an error code.
+* Return		 :  Description in a C-String format.
+*/
+inline const char* GpErrorString(const GpDef::ErrorCode& code)
+{
+	switch (code)
+	{
+	case GpDef::ERR_NONE:				return "No error";
+	case GpDef::ERR_INVALID_DEVICE:		return "Invalid input for argument \"index\". (See definition for GpDef::DeviceID)";
+	case GpDef::ERR_INVALID_BUTTON:		return "Invalid input for argument \"button\". (See definition for GpDef::ButtonID)";
+	case GpDef::ERR_INVALID_CALLBACK:	return "Invalid input for argument fcn";
+	case GpDef::ERR_CALLBACKS_FULL:		return "Too many callbacks registered. (See definition for GP_MAX_CALLBACKS)";
+	case GpDef::ERR_INVALID_ACTION:		return "Invalid input for argument action, or the action has a different ActionType";
+	case GpDef::ERR_INVALID_BINDING:	return "Invalid input for argument action, device, buttons, axis, threshold or component";
+	case GpDef::ERR_ACTIONS_FULL:		return "Too many actions declared. (See definition for GP_MAX_ACTIONS)";
+	default:							return "Unknown error";
+	}
+}
+
+/*
+* Platform independent part of the Gamepad class. "Backend" reads the controllers, and must provide:
+*   bool     GetState(const uint8_t& index, GpDef::RawPadState& state)     : Returns false if the controller is not connected.
+*   void     GetProductName(const uint8_t& index, char* name, size_t len)  : Writes a null-terminated name of at most len bytes.
+*   void     SetVibration(const uint8_t& index, float left, float right)   : Values are in the [0 to 1] range.
+*   uint64_t GetTimestamp()                                                : Microseconds.
+* See GamepadXInput.h for the Windows implementation.
+*/
+template<typename Backend>
+class GamepadCore
+{
+public:
+	GamepadCore() {}
+	~GamepadCore() {}
+	
+	const char* GetClassStr() { return "Gamepad"; }
+
+	/*
+	* Description	 :	Checks for any connected controllers and initializes them.
+	*                   NOTE: Calling this function is only necessary if controllers need to be initialized before calling Tick. 
+	* Return		 :
+	*/
+	void InitDevices()
+	{
+		numConnected = 0;
+
+		for (uint8_t i = 0; i < GP_MAX_COUNT; i++)
+		{
+			gamepads[i].PadState.Reset();
+
+			if (gamepads[i].ID == GPID_DISCONNECTED)
+			{
+				if (backend.GetState(i, gamepads[i].PadState))
+				{
+					gamepads[i].ID = (short)i;
+
+					backend.GetProductName(i, gamepads[i].ProductName, GP_NAME_LEN);
+					
+					numConnected++;
+
+					CallConnectedCallbacks(connectedCallbacks, numConnectedCallbacks, (GpDef::DeviceID)gamepads[i].ID);
+				}
+			}
+		}
+	}
+
+	/*
+	* Description	 :	Returns the number of connected controllers.
+	* Return		 :  Number of connected controllers.
+	*/
+	const uint8_t& ConnectedCount() { return numConnected; }
+
+	/*
+	* Description	 :	Returns the product name of the gamepad specified by it's ID.
+	* Return		 :  Product name in a C-String format.
+	*/
+	const char* GetProductName(const GpDef::DeviceID& index)
+	{ 
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return "";
+		}
+
+		return gamepads[index].ProductName;
+	}
+	
+	/*
+	* Description	 :	Sets the values of X and Y deadzones specifically for thumbsticks.
+	* Return		 :  
+	*/
+	void SetDeadZone(const GpDef::DeviceID& index, const float& deadX, const float& deadY)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return;
+		}
+
+		gamepads[index].Controls.Deadzone.Set(deadX, deadY);
+	}
+	
+	/*
+	* Description	 :	Returns a struct containing the current X and Y deadzone values specifically for thumbsticks.
+	* Return		 :
+	*/
+	const GpDef::DeadzoneStruct& GetDeadZone(const GpDef::DeviceID& index)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return dummyControls.Deadzone;
+		}
+
+		return gamepads[index].Controls.Deadzone;
+	}
+	
+	/*
+	* Description	 :	Checks and updates connectivity status, updates all analog and digital states, then calls the post-tick callback.
+	*                   IMPORTANT: This has to be called before reading any states, or calling comparison functions such as IsTriggeredDown.
+	* Return		 :
+	*/
+	void Tick()
+	{
+		const uint64_t timestamp = backend.GetTimestamp();
+		tickCount++;
+
+		for (uint8_t i = 0; i < GP_MAX_COUNT; i++)
+		{
+			gamepads[i].PrevControls	= gamepads[i].Controls;
+			gamepads[i].PrevID			= gamepads[i].ID;
+
+			//Check for connectivity
+			gamepads[i].PadState.Reset();
+			if (backend.GetState(i, gamepads[i].PadState))
+			{
+				gamepads[i].ID = (short)i;
+				
+				if (gamepads[i].PrevID == GPID_DISCONNECTED)
+				{
+					backend.GetProductName(i, gamepads[i].ProductName, GP_NAME_LEN);
+
+					numConnected++;
+
+					CallConnectedCallbacks(connectedCallbacks, numConnectedCallbacks, (GpDef::DeviceID)gamepads[i].ID);
+				}
+
+				UpdateAnalogInputs((GpDef::DeviceID)i);
+				UpdateDigitalInputs((GpDef::DeviceID)i);
+			}
+			else
+			{
+				if (gamepads[i].ID > GPID_DISCONNECTED)
+				{
+					GpDef::DeviceID disconnectedID = (GpDef::DeviceID)gamepads[i].ID;
+					gamepads[i].Reset();
+
+					if (numConnected > 0)
+						numConnected--;
+
+					CallConnectedCallbacks(disconnectedCallbacks, numDisconnectedCallbacks, disconnectedID);
+				}
+			}
+
+			//Disconnected controllers are recorded as well, so that tick numbers in the history stay consecutive
+			GpDef::InputSnapshot snapshot;
+			snapshot.Pack(gamepads[i].Controls, tickCount, timestamp);
+			gamepads[i].History.Push(snapshot);
+		}
+
+		if (postTickCallback != nullptr)
+			postTickCallback(postTickUsr);
+	}
+
+	/*
+	* Description	 :	Returns the number of the most recent tick. The first call to Tick is numbered 1.
+	* Return		 :  Tick number, or GP_TICK_NONE if Tick has not been called yet.
+	*/
+	const uint32_t& CurrentTick() { return tickCount; }
+	
+	/*
+	* Description	 :	Checks and returns a boolean value indicating the connectivity of a controller specified by it's ID.
+	* Return		 :  true = connected, false = not connected.
+	*/
+	bool IsConnected(const GpDef::DeviceID& index)
+	{ 
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return false;
+		}
+
+		return (gamepads[index].ID > GPID_DISCONNECTED);
+	}
+
+	/*
+	* Description	 :	Sets a user-defined function used to call the registered callbacks. Pass nullptr to call them directly.
+	*                   NOTE: See GamepadAsync.h for asynchronous dispatching.
+	* Return		 :
+	*/
+	void SetCallbackDispatcher(GpCallbackDispatcher dispatcher)
+	{
+		callbackDispatcher = dispatcher;
+	}
+
+	/*
+	* Description	 :	Maps a user-defined function to be called when a controller is connected.
+	* Return		 :  
+	*/
+	void AddGamepadConnectedCallback(GpConnectCallback fcn, void* usr)
+	{
+		if (fcn == nullptr)
+		{
+			GpReportError(GpDef::ERR_INVALID_CALLBACK, __FUNCTION__);
+			return;
+		}
+
+		AddCallback(connectedCallbacks, numConnectedCallbacks, fcn, usr, __FUNCTION__);
+	}
+	
+	/*
+	* Description	 :	Removes mapping of a user-defined function to be called when a controller is connected.
+	* Return		 :  
+	*/
+	void RemoveGamepadConnectedCallback(GpConnectCallback fcn)
+	{
+		if (fcn == nullptr)
+		{
+			GpReportError(GpDef::ERR_INVALID_CALLBACK, __FUNCTION__);
+			return;
+		}
+
+		RemoveCallback(connectedCallbacks, numConnectedCallbacks, fcn);
+	}
+
+	/*
+	* Description	 :	Maps a user-defined function to be called when a controller is disconnected.
+	* Return		 :
+	*/
+	void AddGamepadDisconnectedCallback(GpConnectCallback fcn, void* usr)
+	{
+		if (fcn == nullptr)
+		{
+			GpReportError(GpDef::ERR_INVALID_CALLBACK, __FUNCTION__);
+			return;
+		}
+
+		AddCallback(disconnectedCallbacks, numDisconnectedCallbacks, fcn, usr, __FUNCTION__);
+	}
+
+	/*
+	* Description	 :	Removes mapping of a user-defined function to be called when a controller is disconnected.
+	* Return		 :
+	*/
+	void RemoveGamepadDisconnectedCallback(GpConnectCallback fcn)
+	{
+		if (fcn == nullptr)
+		{
+			GpReportError(GpDef::ERR_INVALID_CALLBACK, __FUNCTION__);
+			return;
+		}
+
+		RemoveCallback(disconnectedCallbacks, numDisconnectedCallbacks, fcn);
+	}
+
+	/*
+	* Description	 :	Returns a struct containing all analog control states.
+	* Return		 :  AnalogStruct.
+	*/
+	const GpDef::AnalogStruct& GetAnalogStates(const GpDef::DeviceID& index)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return dummyControls.Analog;
+		}
+
+		return gamepads[index].Controls.Analog;
+	}
+	
+	/*
+	* Description	 :	Returns a struct containing all digital control states.
+	* Return		 :  DigitalStruct.
+	*/
+	const GpDef::DigitalStruct& GetDigitalStates(const GpDef::DeviceID& index)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return dummyControls.Digital;
+		}
+
+		return gamepads[index].Controls.Digital;
+	}
+	
+	/*
+	* Description	 :	Returns a struct containing all previous analog control states 1 tick earlier.
+	* Return		 :  AnalogStruct.
+	*/
+	const GpDef::AnalogStruct& GetPrevAnalogStates(const GpDef::DeviceID& index)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return dummyControls.Analog;
+		}
+
+		return gamepads[index].PrevControls.Analog;
+	}
+
+	/*
+	* Description	 :	Returns a struct containing all previous digital control states 1 tick earlier.
+	* Return		 :  DigitalStruct.
+	*/
+	const GpDef::DigitalStruct& GetPrevDigitalStates(const GpDef::DeviceID& index)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return dummyControls.Digital;
+		}
+
+		return gamepads[index].PrevControls.Digital;
+	}
+
+	/*
+	* Description	 :	Returns the input history of a controller, holding the last GP_HISTORY_SIZE ticks.
+	* Return		 :  InputHistory.
+	*/
+	const GpDef::InputHistory& GetInputHistory(const GpDef::DeviceID& index)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return dummyHistory;
+		}
+
+		return gamepads[index].History;
+	}
+
+	/*
+	* Description	 :	Returns the recorded inputs of a controller for the given tick.
+	* Return		 :  Pointer to an InputSnapshot, or nullptr if the tick is no longer in the history.
+	*/
+	const GpDef::InputSnapshot* GetSnapshot(const GpDef::DeviceID& index, const uint32_t& tick)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return nullptr;
+		}
+
+		return gamepads[index].History.Get(tick);
+	}
+
+	/*
+	* Description	 :	Copies the recorded inputs of a controller from firstTick to lastTick (inclusive) into "out".
+	*                   "out" must be able to hold (lastTick - firstTick + 1) snapshots.
+	* Return		 :  Number of snapshots copied.
+	*/
+	uint32_t GetSnapshotRange(const GpDef::DeviceID& index, const uint32_t& firstTick, const uint32_t& lastTick, GpDef::InputSnapshot* out)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return 0;
+		}
+
+		return gamepads[index].History.CopyRange(firstTick, lastTick, out);
+	}
+
+	/*
+	* Description	 :	Returns the number of ticks a button has been held down for, including the current tick.
+	* Return		 :  Number of ticks, or 0 if the button is not held.
+	*/
+	uint32_t GetHeldTicks(const GpDef::DeviceID& index, const GpDef::ButtonID& button)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return 0;
+		}
+
+		if (button >= GpDef::BTN_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_BUTTON, __FUNCTION__);
+			return 0;
+		}
+
+		return gamepads[index].History.HeldTicks(button);
+	}
+
+	/*
+	* Description	 :	Returns the time elapsed since a button was pressed down, measured between ticks.
+	* Return		 :  Microseconds, or 0 if the button is not held.
+	*/
+	uint64_t GetHeldTime(const GpDef::DeviceID& index, const GpDef::ButtonID& button)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return 0;
+		}
+
+		if (button >= GpDef::BTN_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_BUTTON, __FUNCTION__);
+			return 0;
+		}
+
+		return gamepads[index].History.HeldTime(button);
+	}
+
+	/*
+	* Description	 :	Returns the tick on which a button was last pressed down. 
+	*                   This is not limited by the size of the history, so it can be used for double-tap detection at any interval.
+	* Return		 :  Tick number, or GP_TICK_NONE if the button has never been pressed.
+	*/
+	uint32_t GetLastPressedTick(const GpDef::DeviceID& index, const GpDef::ButtonID& button)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return GP_TICK_NONE;
+		}
+
+		if (button >= GpDef::BTN_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_BUTTON, __FUNCTION__);
+			return GP_TICK_NONE;
+		}
+
+		return gamepads[index].History.PressedTick[button];
+	}
+
+	/*
+	* Description	 :	Returns the timestamp of the tick on which a button was last pressed down.
+	*                   This is not limited by the size of the history.
+	* Return		 :  Microseconds, or 0 if the button has never been pressed.
+	*/
+	uint64_t GetLastPressedTime(const GpDef::DeviceID& index, const GpDef::ButtonID& button)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return 0;
+		}
+
+		if (button >= GpDef::BTN_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_BUTTON, __FUNCTION__);
+			return 0;
+		}
+
+		return gamepads[index].History.PressedTime[button];
+	}
+
+	/*
+	* Description	 :	Returns the tick on which a button was last released.
+	* Return		 :  Tick number, or GP_TICK_NONE if the button has never been released.
+	*/
+	uint32_t GetLastReleasedTick(const GpDef::DeviceID& index, const GpDef::ButtonID& button)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return GP_TICK_NONE;
+		}
+
+		if (button >= GpDef::BTN_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_BUTTON, __FUNCTION__);
+			return GP_TICK_NONE;
+		}
+
+		return gamepads[index].History.ReleasedTick[button];
+	}
+
+	/*
+	* Description	 :	Sets the vibration levels for the left and right motors using the arguments "left" and "right".
+	* Return		 :  
+	*/
+	void SetVibration(const GpDef::DeviceID& index, const float& left, const float& right)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return;
+		}
+
+		float leftVal  = left;
+		float rightVal = right;
+		BoundValueRange(leftVal, 0.0f, 1.0f);
+		BoundValueRange(rightVal, 0.0f, 1.0f);
+
+		gamepads[index].Controls.Analog.Vibration_L = leftVal;
+		gamepads[index].Controls.Analog.Vibration_R = rightVal;
+
+		backend.SetVibration(index, leftVal, rightVal);
+	}
+
+protected:
+	/*
+	* Description	 :	Sets a function to be called at the end of every Tick, so that derived classes can extend Tick
+	*                   without hiding it. (See Gamepad::EvaluateActionMap)
+	* Return		 :
+	*/
+	void SetPostTickCallback(GpTickCallback fcn, void* usr)
+	{
+		postTickCallback = fcn;
+		postTickUsr      = usr;
+	}
+
+private:
+	GamepadCore(const GamepadCore& other) = delete;
+	GamepadCore& operator=(const GamepadCore& other) = delete;
+
+	struct CallbackEntry
+	{
+		GpConnectCallback	Fcn;
+		void*				Usr;
+	};
+
+	Backend backend;
+	GpDef::GamepadState gamepads[GP_MAX_COUNT];
+	GpDef::ControlsStruct dummyControls;	//For error handling
+	GpDef::InputHistory dummyHistory;		//For error handling
+	uint8_t numConnected = 0;
+	uint32_t tickCount = GP_TICK_NONE;
+	CallbackEntry connectedCallbacks[GP_MAX_CALLBACKS];
+	CallbackEntry disconnectedCallbacks[GP_MAX_CALLBACKS];
+	uint8_t numConnectedCallbacks = 0;
+	uint8_t numDisconnectedCallbacks = 0;
+	GpCallbackDispatcher callbackDispatcher = nullptr;
+	GpTickCallback postTickCallback = nullptr;
+	void* postTickUsr = nullptr;
+
+	inline void UpdateDigitalInputs(const GpDef::DeviceID& index)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return;
+		}
+
+		gamepads[index].Controls.Digital.FromMask(gamepads[index].PadState.Buttons);
+	}
+
+	inline void UpdateAnalogInputs(const GpDef::DeviceID& index)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return;
+		}
+
+		GpDef::AnalogStruct& analog           = gamepads[index].Controls.Analog;
+		const GpDef::RawPadState& padState    = gamepads[index].PadState;
+		const GpDef::DeadzoneStruct& deadZone = gamepads[index].Controls.Deadzone;
+
+		//Left & Right Triggers (Normalized to [0 to 1] range)
+		analog.Trigger_L = padState.Trigger_L / 255.0f;
+		analog.Trigger_R = padState.Trigger_R / 255.0f;
+		//Left & Right Thumbsticks (Normalized to [-1 to 1] range)
+		analog.Thumb_L_X = MaxVal(-1.0f, padState.Thumb_L_X / 32767.0f);
+		analog.Thumb_L_Y = MaxVal(-1.0f, padState.Thumb_L_Y / 32767.0f);
+		analog.Thumb_R_X = MaxVal(-1.0f, padState.Thumb_R_X / 32767.0f);
+		analog.Thumb_R_Y = MaxVal(-1.0f, padState.Thumb_R_Y / 32767.0f);
+		//Account for deadzones
+		analog.Thumb_L_X = (std::abs(analog.Thumb_L_X) < deadZone.X) ? 0.0f : analog.Thumb_L_X;
+		analog.Thumb_L_Y = (std::abs(analog.Thumb_L_Y) < deadZone.Y) ? 0.0f : analog.Thumb_L_Y;
+		analog.Thumb_R_X = (std::abs(analog.Thumb_R_X) < deadZone.X) ? 0.0f : analog.Thumb_R_X;
+		analog.Thumb_R_Y = (std::abs(analog.Thumb_R_Y) < deadZone.Y) ? 0.0f : analog.Thumb_R_Y;
+	}
+
+	template<typename T>
+	inline T MaxVal(const T& a, const T& b)	//Declared this in case NOMINMAX was defined
+	{
+		return (a > b) ? a : b;
+	}
+
+	template<typename T1, typename T2>
+	inline void BoundValueRange(T1& value, const T2& minVal, const T2& maxVal)
+	{
+		value = (value < minVal) ? minVal : value;
+		value = (value > maxVal) ? maxVal : value;
+	}
+
+	inline void AddCallback(CallbackEntry* entries, uint8_t& count, GpConnectCallback fcn, void* usr, const char* function)
+	{
+		for (uint8_t i = 0; i < count; i++)
+		{
+			if (entries[i].Fcn == fcn)
+			{
+				entries[i].Usr = usr;
+				return;
+			}
+		}
+
+		if (count >= GP_MAX_CALLBACKS)
+		{
+			GpReportError(GpDef::ERR_CALLBACKS_FULL, function);
+			return;
+		}
+
+		entries[count].Fcn = fcn;
+		entries[count].Usr = usr;
+		count++;
+	}
+
+	inline void RemoveCallback(CallbackEntry* entries, uint8_t& count, GpConnectCallback fcn)
+	{
+		for (uint8_t i = 0; i < count; i++)
+		{
+			if (entries[i].Fcn == fcn)
+			{
+				entries[i] = entries[count - 1];
+				count--;
+				return;
+			}
+		}
+	}
+
+	inline void CallConnectedCallbacks(const CallbackEntry* entries, const uint8_t& count, const GpDef::DeviceID& gamepadID)
+	{
+		for (uint8_t i = 0; i < count; i++)
+		{
+			if (callbackDispatcher != nullptr)
+				callbackDispatcher(entries[i].Fcn, entries[i].Usr, gamepadID);
+			else	
+				entries[i].Fcn(entries[i].Usr, gamepadID);
+		}
+	}
+};
+
+#endif
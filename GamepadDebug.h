@@ -0,0 +1,99 @@
+// MIT License
+
+// Copyright (c) 2022 Jashen Low
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#ifndef _GAMEPAD_DEBUG_H_
+#define _GAMEPAD_DEBUG_H_
+
+//Debugging helpers. These are the only parts of the library that depend on iostreams.
+
+#include "GamepadCore.h"
+#include <iostream>
+#include <sstream>
+
+namespace GpDebug
+{
+	/*
+	* Description	 :	Error callback that prints errors to std::cerr. (See GpSetErrorCallback)
+	* Return		 :
+	*/
+	inline void ErrorToStderr(void* /*usr*/, GpDef::ErrorCode code, const char* function)
+	{
+		std::cerr << function << ": " << GpErrorString(code) << std::endl;
+	}
+
+	/*
+	* Description	 :	Appends state data of all controls into an output stream. This is called mainly for debugging purposes.
+	* Return		 :
+	*/
+	template<typename GamepadT>
+	void DumpToStream(GamepadT& gamepad, const GpDef::DeviceID& index, const GpDef::StreamType& type, std::ostringstream& stream)
+	{
+		if (index >= GP_MAX_COUNT)
+		{
+			GpReportError(GpDef::ERR_INVALID_DEVICE, __FUNCTION__);
+			return;
+		}
+
+		stream.str("");
+
+		if ((type == GpDef::StreamType::STREAM_ALL) || (type == GpDef::StreamType::STREAM_ANALOG))
+		{
+			const GpDef::AnalogStruct& analog = gamepad.GetAnalogStates(index);
+
+			stream << gamepad.GetClassStr() << ": " << "--------ANALOG----------" << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Trigger_L   = " << analog.Trigger_L << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Trigger_R   = " << analog.Trigger_R << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Thumb_L_X   = " << analog.Thumb_L_X << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Thumb_L_Y   = " << analog.Thumb_L_Y << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Thumb_R_X   = " << analog.Thumb_R_X << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Thumb_R_Y   = " << analog.Thumb_R_Y << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Vibration_L = " << analog.Vibration_L << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Vibration_R = " << analog.Vibration_R << std::endl;
+		}
+
+		if ((type == GpDef::StreamType::STREAM_ALL) || (type == GpDef::StreamType::STREAM_DIGITAL))
+		{
+			const GpDef::DigitalStruct& digital = gamepad.GetDigitalStates(index);
+
+			stream << gamepad.GetClassStr() << ": " << "--------DIGITAL----------" << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Face_A         = " << (digital.Face_A ? "TRUE" : "FALSE") << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Face_B         = " << (digital.Face_B ? "TRUE" : "FALSE") << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Face_X         = " << (digital.Face_X ? "TRUE" : "FALSE") << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Face_Y         = " << (digital.Face_Y ? "TRUE" : "FALSE") << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Dpad_Left      = " << (digital.Dpad_Left ? "TRUE" : "FALSE") << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Dpad_Right     = " << (digital.Dpad_Right ? "TRUE" : "FALSE") << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Dpad_Up        = " << (digital.Dpad_Up ? "TRUE" : "FALSE") << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Dpad_Down      = " << (digital.Dpad_Down ? "TRUE" : "FALSE") << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Shoulder_Left  = " << (digital.Shoulder_Left ? "TRUE" : "FALSE") << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Shoulder_Right = " << (digital.Shoulder_Right ? "TRUE" : "FALSE") << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Thumb_Left     = " << (digital.Thumb_Left ? "TRUE" : "FALSE") << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Thumb_Right    = " << (digital.Thumb_Right ? "TRUE" : "FALSE") << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Back           = " << (digital.Back ? "TRUE" : "FALSE") << std::endl;
+			stream << gamepad.GetClassStr() << ": " << "Start          = " << (digital.Start ? "TRUE" : "FALSE") << std::endl;
+		}
+
+		stream << std::endl;
+	}
+}
+
+#endif
@@ -0,0 +1,132 @@
+// MIT License
+
+// Copyright (c) 2022 Jashen Low
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#ifndef _GAMEPAD_XINPUT_H_
+#define _GAMEPAD_XINPUT_H_
+
+//XInput backend for GamepadCore. (Windows only)
+
+#include "GamepadCore.h"
+#include <Windows.h>	//This must be included BEFORE Xinput.h!
+#include <Xinput.h>
+
+#ifdef WIN32_LEAN_AND_MEAN
+#include <mmsyscom.h>
+#endif
+
+#pragma comment (lib, "xinput.lib")
+#pragma comment (lib, "winmm.lib")
+
+static_assert(XUSER_MAX_COUNT == GP_MAX_COUNT, "GP_MAX_COUNT must match XUSER_MAX_COUNT");
+static_assert(MAXPNAMELEN == GP_NAME_LEN, "GP_NAME_LEN must match MAXPNAMELEN");
+
+class GpXInputBackend
+{
+public:
+	GpXInputBackend()
+	{
+		LARGE_INTEGER freq;
+		QueryPerformanceFrequency(&freq);
+		timerFrequency = (uint64_t)freq.QuadPart;
+	}
+
+	inline bool GetState(const uint8_t& index, GpDef::RawPadState& state)
+	{
+		XINPUT_STATE padState;
+		ZeroMemory(&padState, sizeof(XINPUT_STATE));
+
+		if (XInputGetState((DWORD)index, &padState) != ERROR_SUCCESS)
+			return false;
+
+		const WORD& psButtons = padState.Gamepad.wButtons;
+
+		state.Buttons = (uint16_t)(
+			//Face Buttons
+			(((psButtons & XINPUT_GAMEPAD_A) != 0) << GpDef::BTN_FACE_A) |
+			(((psButtons & XINPUT_GAMEPAD_B) != 0) << GpDef::BTN_FACE_B) |
+			(((psButtons & XINPUT_GAMEPAD_X) != 0) << GpDef::BTN_FACE_X) |
+			(((psButtons & XINPUT_GAMEPAD_Y) != 0) << GpDef::BTN_FACE_Y) |
+			//Direction Pad Buttons
+			(((psButtons & XINPUT_GAMEPAD_DPAD_LEFT) != 0)  << GpDef::BTN_DPAD_LEFT) |
+			(((psButtons & XINPUT_GAMEPAD_DPAD_RIGHT) != 0) << GpDef::BTN_DPAD_RIGHT) |
+			(((psButtons & XINPUT_GAMEPAD_DPAD_UP) != 0)    << GpDef::BTN_DPAD_UP) |
+			(((psButtons & XINPUT_GAMEPAD_DPAD_DOWN) != 0)  << GpDef::BTN_DPAD_DOWN) |
+			//Shoulder Buttons
+			(((psButtons & XINPUT_GAMEPAD_LEFT_SHOULDER) != 0)  << GpDef::BTN_SHOULDER_LEFT) |
+			(((psButtons & XINPUT_GAMEPAD_RIGHT_SHOULDER) != 0) << GpDef::BTN_SHOULDER_RIGHT) |
+			//Thumb Sticks (Press)
+			(((psButtons & XINPUT_GAMEPAD_LEFT_THUMB) != 0)  << GpDef::BTN_THUMB_LEFT) |
+			(((psButtons & XINPUT_GAMEPAD_RIGHT_THUMB) != 0) << GpDef::BTN_THUMB_RIGHT) |
+			//Center Buttons
+			(((psButtons & XINPUT_GAMEPAD_BACK) != 0)  << GpDef::BTN_BACK) |
+			(((psButtons & XINPUT_GAMEPAD_START) != 0) << GpDef::BTN_START)
+			);
+
+		state.Trigger_L = padState.Gamepad.bLeftTrigger;
+		state.Trigger_R = padState.Gamepad.bRightTrigger;
+		state.Thumb_L_X = padState.Gamepad.sThumbLX;
+		state.Thumb_L_Y = padState.Gamepad.sThumbLY;
+		state.Thumb_R_X = padState.Gamepad.sThumbRX;
+		state.Thumb_R_Y = padState.Gamepad.sThumbRY;
+
+		return true;
+	}
+
+	inline void GetProductName(const uint8_t& index, char* name, const size_t& len)
+	{
+		JOYCAPSA devInfo;
+		ZeroMemory(&devInfo, sizeof(devInfo));
+		memset(name, '\0', len);
+
+		//Get Gamepad Device Name
+		if (joyGetDevCapsA(index, &devInfo, sizeof(devInfo)) != JOYERR_NOERROR)
+			return;
+
+		size_t nameLen = ((strlen(devInfo.szPname) + 1) < len) ? strlen(devInfo.szPname) + 1 : len;
+		memcpy(name, devInfo.szPname, nameLen);
+		name[len - 1] = '\0';
+	}
+
+	inline void SetVibration(const uint8_t& index, const float& left, const float& right)
+	{
+		XINPUT_VIBRATION vibState;
+		vibState.wLeftMotorSpeed  = (WORD)(65535.0f * left);
+		vibState.wRightMotorSpeed = (WORD)(65535.0f * right);
+
+		XInputSetState((DWORD)index, &vibState);
+	}
+
+	inline uint64_t GetTimestamp()	//Microseconds
+	{
+		LARGE_INTEGER counter;
+		QueryPerformanceCounter(&counter);
+
+		const uint64_t ticks = (uint64_t)counter.QuadPart;
+		return ((ticks / timerFrequency) * 1000000) + (((ticks % timerFrequency) * 1000000) / timerFrequency);
+	}
+
+private:
+	uint64_t timerFrequency = 1;
+};
+
+#endif